@@ -9,8 +9,28 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <sstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 enum tailwidthmethod {T=1,C=2};
 
@@ -82,6 +102,724 @@ double TailWidthToCarapaceLength(double tw, int sex, int cra)
 }
 
 
+//Bathymetry raster
+//A gridded depth raster in ESRI format used to look up the bathymetric depth at
+//the position of each release and recapture. Binary grids (a `.hdr` header file and
+//a `.flt` file of 32 bit floats) are memory mapped so that only the pages that
+//are actually needed get read. ESRI ASCII grids (`.asc`) are parsed into memory.
+class Bathymetry {
+public:
+   //Grid dimensions
+   int Cols;
+   int Rows;
+   //Coordinates of the lower left corner of the grid and size of each cell (decimal degrees)
+   double XLL;
+   double YLL;
+   double CellSize;
+   //Value used for cells without data
+   float NoData;
+
+   //Size of the square blocks of cells used to order lookups
+   static const int TileSize = 64;
+
+   Bathymetry():
+      Cols(0),
+      Rows(0),
+      XLL(0),
+      YLL(0),
+      CellSize(1),
+      NoData(-9999),
+      Values(nullptr),
+      Swap(false),
+      Map(nullptr),
+      MapSize(0)
+   {}
+
+   ~Bathymetry()
+   {
+      Close();
+   }
+
+   //Not copyable because it may own a memory mapping
+   Bathymetry(const Bathymetry&) = delete;
+   Bathymetry& operator=(const Bathymetry&) = delete;
+
+   //Open a grid. The filename is either an ESRI ASCII grid ending in `.asc` or the
+   //base name of an ESRI binary grid (e.g. "bathymetry" for "bathymetry.hdr" and "bathymetry.flt")
+   bool Open(const std::string& filename)
+   {
+      Close();
+      if(filename.size()>4 && filename.substr(filename.size()-4)==".asc") return OpenAscii(filename);
+      else return OpenBinary(filename);
+   }
+
+   void Close(void)
+   {
+      if(Map != nullptr) munmap(Map,MapSize);
+      Map = nullptr;
+      MapSize = 0;
+      Owned.clear();
+      Values = nullptr;
+      Swap = false;
+      //Reset the header so that nothing carries over to the next grid opened
+      Cols = Rows = 0;
+      XLL = YLL = 0;
+      CellSize = 1;
+      NoData = -9999;
+   }
+
+   bool Good(void) const
+   {
+      return Values != nullptr;
+   }
+
+   //Tile containing a position, or -1 if the position is off the grid. Lookups
+   //ordered by tile touch the same few pages of the grid rather than jumping about.
+   long Tile(double lat, double lon) const
+   {
+      if(not std::isfinite(lat) or not std::isfinite(lon)) return -1;
+      double col = (Wrap(lon)-XLL)/CellSize;
+      double row = Rows - (lat-YLL)/CellSize;
+      if(col<0 || col>=Cols || row<0 || row>=Rows) return -1;
+      long tilecols = (Cols+TileSize-1)/TileSize;
+      return (long(row)/TileSize)*tilecols + long(col)/TileSize;
+   }
+
+   //Depth at a position using bilinear interpolation between the centres of the four
+   //surrounding cells. Cells without data are dropped and the weights of the remaining
+   //cells rescaled. Returns NAN if the position is off the grid or has no data nearby.
+   float Lookup(double lat, double lon) const
+   {
+      if(Tile(lat,lon)<0) return NAN;
+      //Position relative to cell centres (grid rows are stored from north to south)
+      double x = (Wrap(lon)-XLL)/CellSize - 0.5;
+      double y = Rows - (lat-YLL)/CellSize - 0.5;
+      //Clamp to the centres of the outer cells
+      x = std::min(std::max(x,0.0),double(Cols-1));
+      y = std::min(std::max(y,0.0),double(Rows-1));
+      int c0 = int(x), r0 = int(y);
+      int c1 = std::min(c0+1,Cols-1), r1 = std::min(r0+1,Rows-1);
+      double fx = x-c0, fy = y-r0;
+
+      double sum = 0, weights = 0;
+      Accumulate(r0,c0,(1-fx)*(1-fy),sum,weights);
+      Accumulate(r0,c1,fx*(1-fy),sum,weights);
+      Accumulate(r1,c0,(1-fx)*fy,sum,weights);
+      Accumulate(r1,c1,fx*fy,sum,weights);
+      if(weights>0) return sum/weights;
+      else return NAN;
+   }
+
+private:
+   //Cell values, row by row from the north
+   const float* Values;
+   //Whether values are stored in the opposite byte order to this machine
+   bool Swap;
+   //Memory mapping of a binary grid
+   void* Map;
+   size_t MapSize;
+   //Values read from an ASCII grid
+   std::vector<float> Owned;
+
+   //Shift a longitude by multiples of 360 so that it is east of the grid's western edge
+   //and within 360 degrees of it. West longitudes (e.g. the Chatham Islands) then fall
+   //on grids that use 0-360 longitudes.
+   double Wrap(double lon) const
+   {
+      if(lon<XLL) lon += 360*std::ceil((XLL-lon)/360);
+      else if(lon>=XLL+360) lon -= 360*std::floor((lon-XLL)/360);
+      return lon;
+   }
+
+   float Value(int row, int col) const
+   {
+      float value = Values[size_t(row)*Cols+col];
+      if(Swap){
+         uint32_t bits;
+         std::memcpy(&bits,&value,4);
+         bits = (bits>>24) | ((bits>>8)&0xff00) | ((bits<<8)&0xff0000) | (bits<<24);
+         std::memcpy(&value,&bits,4);
+      }
+      return value;
+   }
+
+   void Accumulate(int row, int col, double weight, double& sum, double& weights) const
+   {
+      float value = Value(row,col);
+      if(std::isfinite(value) and value != NoData){
+         sum += weight*value;
+         weights += weight;
+      }
+   }
+
+   //Read the header keywords common to binary and ASCII grids. For ASCII grids
+   //this stops at the first value, which is returned in `first`. For binary grids
+   //the whole file is read and other keywords (e.g. `nbits`) are skipped.
+   bool Header(std::istream& file, std::string& byteorder, std::string& first, bool ascii)
+   {
+      bool xcentre = false, ycentre = false;
+      std::string key;
+      while(file>>key){
+         //Keywords are case insensitive
+         for(char& c : key) c = std::tolower(c);
+         if(key=="ncols") file>>Cols;
+         else if(key=="nrows") file>>Rows;
+         else if(key=="xllcorner") file>>XLL;
+         else if(key=="yllcorner") file>>YLL;
+         else if(key=="xllcenter"){file>>XLL;xcentre = true;}
+         else if(key=="yllcenter"){file>>YLL;ycentre = true;}
+         else if(key=="cellsize") file>>CellSize;
+         else if(key=="nodata_value") file>>NoData;
+         else if(key=="byteorder") file>>byteorder;
+         else if(ascii){
+            //Not a keyword so must be the first value
+            first = key;
+            break;
+         }
+         else{
+            //Skip the value of a keyword that is not needed
+            std::string value;
+            file>>value;
+         }
+      }
+      //Convert cell centre to cell corner
+      if(xcentre) XLL -= CellSize/2;
+      if(ycentre) YLL -= CellSize/2;
+      return Cols>0 && Rows>0 && CellSize>0;
+   }
+
+   bool OpenAscii(const std::string& filename)
+   {
+      std::ifstream file(filename);
+      std::string byteorder, first;
+      if(not file.good() or not Header(file,byteorder,first,true) or first.empty()) return false;
+      //The first value must be a number rather than an unknown keyword
+      char* end;
+      float value = std::strtof(first.c_str(),&end);
+      if(*end != '\0') return false;
+      Owned.resize(size_t(Cols)*Rows);
+      Owned[0] = value;
+      for(size_t i=1;i<Owned.size();i++)
+         if(not (file>>Owned[i])){
+            Owned.clear();
+            return false;
+         }
+      Values = Owned.data();
+      Swap = false;
+      return true;
+   }
+
+   bool OpenBinary(const std::string& basename)
+   {
+      std::ifstream header(basename+".hdr");
+      std::string byteorder, first;
+      if(not header.good() or not Header(header,byteorder,first,false)) return false;
+
+      int fd = open((basename+".flt").c_str(),O_RDONLY);
+      if(fd<0) return false;
+      struct stat info;
+      size_t size = size_t(Cols)*Rows*sizeof(float);
+      if(fstat(fd,&info)!=0 || size_t(info.st_size)<size){
+         close(fd);
+         return false;
+      }
+      void* map = mmap(nullptr,size,PROT_READ,MAP_SHARED,fd,0);
+      //The mapping remains valid after the file is closed
+      close(fd);
+      if(map == MAP_FAILED) return false;
+
+      Map = map;
+      MapSize = size;
+      Values = static_cast<const float*>(map);
+      //ESRI binary grids are little endian unless stated otherwise
+      uint16_t one = 1;
+      bool little = *reinterpret_cast<uint8_t*>(&one) == 1;
+      for(char& c : byteorder) c = std::toupper(c);
+      bool msb = byteorder=="MSBFIRST" || byteorder=="M";
+      Swap = (msb == little);
+      return true;
+   }
+
+};//class Bathymetry
+
+//Flatbuffer builder
+//A minimal builder for the flatbuffers used in Arrow IPC metadata. As in the
+//flatbuffers library the buffer is built from the back so that references always
+//point forward. Positions (`Offset`s) are measured from the end of the buffer.
+class FlatBuffer {
+public:
+   typedef uint32_t Offset;
+
+   Offset Size(void) const
+   {
+      return Bytes.size();
+   }
+
+   //Pad so that after adding `size` more bytes the start is aligned to `alignment`
+   void Align(size_t size, size_t alignment)
+   {
+      while((Bytes.size()+size)%alignment) Push<uint8_t>(0);
+   }
+
+   template<typename Type>
+   void Push(Type value)
+   {
+      uint8_t bytes[sizeof(Type)];
+      std::memcpy(bytes,&value,sizeof(Type));
+      Bytes.insert(Bytes.begin(),bytes,bytes+sizeof(Type));
+   }
+
+   template<typename Type>
+   void Scalar(Type value)
+   {
+      Align(sizeof(Type),sizeof(Type));
+      Push(value);
+   }
+
+   void Reference(Offset target)
+   {
+      Align(4,4);
+      Push<uint32_t>(Size()+4-target);
+   }
+
+   Offset String(const std::string& value)
+   {
+      Align(value.size()+1,4);
+      Push<uint8_t>(0);
+      Bytes.insert(Bytes.begin(),value.begin(),value.end());
+      Push<uint32_t>(value.size());
+      return Size();
+   }
+
+   //Vector of references to tables
+   Offset Vector(const std::vector<Offset>& items)
+   {
+      Align(4*items.size(),4);
+      for(size_t i=items.size();i>0;i--) Push<uint32_t>(Size()+4-items[i-1]);
+      Push<uint32_t>(items.size());
+      return Size();
+   }
+
+   //Vector of `count` structs already laid out in `data`
+   Offset Structs(const std::vector<uint8_t>& data, size_t count, size_t alignment)
+   {
+      Align(data.size(),std::max<size_t>(alignment,4));
+      Bytes.insert(Bytes.begin(),data.begin(),data.end());
+      Push<uint32_t>(count);
+      return Size();
+   }
+
+   //Tables are built by adding fields between `Start` and `End`. Any strings, vectors
+   //or tables that they reference must be built beforehand.
+   void Start(void)
+   {
+      Fields.clear();
+      TableEnd = Size();
+   }
+
+   template<typename Type>
+   void Field(int id, Type value)
+   {
+      Scalar(value);
+      Mark(id);
+   }
+
+   void FieldReference(int id, Offset target)
+   {
+      Reference(target);
+      Mark(id);
+   }
+
+   Offset End(void)
+   {
+      //Placeholder for the offset to the vtable
+      Align(4,4);
+      Push<int32_t>(0);
+      Offset table = Size();
+      //The vtable: its size, the table's size and the position of each field within the table
+      for(size_t id=Fields.size();id>0;id--) Push<uint16_t>(Fields[id-1]?table-Fields[id-1]:0);
+      Push<uint16_t>(table-TableEnd);
+      Push<uint16_t>(4+2*Fields.size());
+      int32_t vtable = Size()-table;
+      std::memcpy(&Bytes[Bytes.size()-table],&vtable,4);
+      return table;
+   }
+
+   //Add the reference to the root table and return the buffer
+   const std::vector<uint8_t>& Finish(Offset root)
+   {
+      Align(4,8);
+      Reference(root);
+      return Bytes;
+   }
+
+private:
+   std::vector<uint8_t> Bytes;
+   //Position of each field of the table being built (0 if absent)
+   std::vector<Offset> Fields;
+   Offset TableEnd;
+
+   void Mark(int id)
+   {
+      if(Fields.size()<=size_t(id)) Fields.resize(id+1,0);
+      Fields[id] = Size();
+   }
+
+};//class FlatBuffer
+
+//Arrow table
+//A table of typed columns written as an Arrow IPC file (also known as Feather V2)
+//so that it can be memory mapped by R and Python without parsing. Floating point
+//NANs are written as nulls and string columns can be dictionary encoded. Values are
+//written in the byte order of this machine which is assumed to be little endian.
+class ArrowTable {
+public:
+   ArrowTable():
+      Rows(0)
+   {}
+
+   void Int(const std::string& name, const std::vector<int32_t>& values)
+   {
+      Column& column = Add(name,Int32,values.size());
+      Copy(column,values);
+   }
+
+   void Float(const std::string& name, const std::vector<float>& values)
+   {
+      Column& column = Add(name,Float32,values.size());
+      Copy(column,values);
+      Nulls(column,values);
+   }
+
+   void Double(const std::string& name, const std::vector<double>& values)
+   {
+      Column& column = Add(name,Float64,values.size());
+      Copy(column,values);
+      Nulls(column,values);
+   }
+
+   void String(const std::string& name, const std::vector<std::string>& values)
+   {
+      Column& column = Add(name,Utf8,values.size());
+      column.Strings = values;
+   }
+
+   //A string column stored as indices into a dictionary of its unique values
+   void Dictionary(const std::string& name, const std::vector<std::string>& values)
+   {
+      Column& column = Add(name,Dict,values.size());
+      std::unordered_map<std::string,int32_t> codes;
+      std::vector<int32_t> indices;
+      indices.reserve(values.size());
+      for(const std::string& value : values){
+         auto code = codes.find(value);
+         if(code == codes.end()){
+            code = codes.insert(std::make_pair(value,int32_t(column.Strings.size()))).first;
+            column.Strings.push_back(value);
+         }
+         indices.push_back(code->second);
+      }
+      Copy(column,indices);
+   }
+
+   //Write the table. Nothing is written, and false returned, if the columns
+   //are not all the same length.
+   bool Write(std::ostream& file)
+   {
+      if(not Error.empty()){
+         std::cerr<<"Not writing Arrow table: "<<Error<<"\n";
+         return false;
+      }
+      int64_t position = 0;
+      //Magic number padded to 8 bytes
+      Bytes(file,position,"ARROW1\0\0",8);
+
+      //Schema
+      {
+         FlatBuffer fb;
+         FlatBuffer::Offset schema = Schema(fb);
+         Message(file,position,Header(fb,1,schema,0),std::vector<uint8_t>());
+      }
+
+      //A dictionary batch for each dictionary encoded column
+      std::vector<Block> dictionaries;
+      for(size_t i=0;i<Columns.size();i++){
+         const Column& column = Columns[i];
+         if(column.Type != Dict) continue;
+         std::vector<uint8_t> body;
+         std::vector<Buffer> buffers;
+         std::vector<Node> nodes(1,Node{int64_t(column.Strings.size()),0});
+         //Dictionary values have no nulls so an empty validity buffer
+         Append(body,buffers,std::vector<uint8_t>());
+         StringBuffers(body,buffers,column.Strings);
+
+         FlatBuffer fb;
+         FlatBuffer::Offset batch = RecordBatch(fb,column.Strings.size(),nodes,buffers);
+         fb.Start();
+         fb.Field<int64_t>(0,i);
+         fb.FieldReference(1,batch);
+         fb.Field<uint8_t>(2,0);
+         FlatBuffer::Offset dictionary = fb.End();
+         dictionaries.push_back(Message(file,position,Header(fb,2,dictionary,body.size()),body));
+      }
+
+      //A single record batch containing all rows
+      std::vector<Block> batches;
+      {
+         std::vector<uint8_t> body;
+         std::vector<Buffer> buffers;
+         std::vector<Node> nodes;
+         for(const Column& column : Columns){
+            nodes.push_back(Node{Rows,column.NullCount});
+            Append(body,buffers,column.Validity);
+            if(column.Type == Utf8) StringBuffers(body,buffers,column.Strings);
+            else Append(body,buffers,column.Values);
+         }
+         FlatBuffer fb;
+         FlatBuffer::Offset batch = RecordBatch(fb,Rows,nodes,buffers);
+         batches.push_back(Message(file,position,Header(fb,3,batch,body.size()),body));
+      }
+
+      //End of stream marker
+      Scalar<uint32_t>(file,position,0xFFFFFFFF);
+      Scalar<int32_t>(file,position,0);
+
+      //Footer
+      FlatBuffer fb;
+      FlatBuffer::Offset schema = Schema(fb);
+      FlatBuffer::Offset dictionaryblocks = Blocks(fb,dictionaries);
+      FlatBuffer::Offset batchblocks = Blocks(fb,batches);
+      fb.Start();
+      fb.Field<int16_t>(0,Version);
+      fb.FieldReference(1,schema);
+      fb.FieldReference(2,dictionaryblocks);
+      fb.FieldReference(3,batchblocks);
+      const std::vector<uint8_t>& footer = fb.Finish(fb.End());
+      Bytes(file,position,footer.data(),footer.size());
+      Scalar<int32_t>(file,position,footer.size());
+      Bytes(file,position,"ARROW1",6);
+      return file.good();
+   }
+
+private:
+   //Arrow metadata version V5
+   static const int16_t Version = 4;
+
+   enum ColumnType {Int32,Float32,Float64,Utf8,Dict};
+
+   struct Column {
+      std::string Name;
+      ColumnType Type;
+      //Fixed width values, or dictionary indices
+      std::vector<uint8_t> Values;
+      //Validity bitmap, empty if there are no nulls
+      std::vector<uint8_t> Validity;
+      int64_t NullCount;
+      //String values, or dictionary values
+      std::vector<std::string> Strings;
+   };
+
+   //Flatbuffer structs describing record batches and the file layout
+   struct Node {
+      int64_t Length;
+      int64_t NullCount;
+   };
+   struct Buffer {
+      int64_t Offset;
+      int64_t Length;
+   };
+   struct Block {
+      int64_t Offset;
+      int32_t MetaDataLength;
+      int32_t Padding;
+      int64_t BodyLength;
+   };
+
+   std::vector<Column> Columns;
+   int64_t Rows;
+   //Description of the first inconsistency in the columns added
+   std::string Error;
+
+   Column& Add(const std::string& name, ColumnType type, size_t rows)
+   {
+      if(Columns.empty()) Rows = rows;
+      else if(int64_t(rows) != Rows && Error.empty()){
+         std::ostringstream error;
+         error<<"column "<<name<<" has "<<rows<<" rows rather than "<<Rows;
+         Error = error.str();
+      }
+      Columns.push_back(Column());
+      Column& column = Columns.back();
+      column.Name = name;
+      column.Type = type;
+      column.NullCount = 0;
+      return column;
+   }
+
+   template<typename Type>
+   void Copy(Column& column, const std::vector<Type>& values)
+   {
+      column.Values.resize(values.size()*sizeof(Type));
+      if(values.size()) std::memcpy(column.Values.data(),values.data(),column.Values.size());
+   }
+
+   template<typename Type>
+   void Nulls(Column& column, const std::vector<Type>& values)
+   {
+      std::vector<uint8_t> validity((values.size()+7)/8,0);
+      for(size_t i=0;i<values.size();i++){
+         if(std::isfinite(values[i])) validity[i/8] |= 1<<(i%8);
+         else column.NullCount++;
+      }
+      if(column.NullCount>0) column.Validity = validity;
+   }
+
+   //Add a buffer to a message body padded to a multiple of 8 bytes
+   static void Append(std::vector<uint8_t>& body, std::vector<Buffer>& buffers, const std::vector<uint8_t>& data)
+   {
+      buffers.push_back(Buffer{int64_t(body.size()),int64_t(data.size())});
+      body.insert(body.end(),data.begin(),data.end());
+      body.resize((body.size()+7)/8*8,0);
+   }
+
+   //Add the offsets and data buffers for strings
+   static void StringBuffers(std::vector<uint8_t>& body, std::vector<Buffer>& buffers, const std::vector<std::string>& strings)
+   {
+      std::vector<int32_t> offsets(1,0);
+      std::string data;
+      for(const std::string& value : strings){
+         data += value;
+         offsets.push_back(data.size());
+      }
+      Append(body,buffers,std::vector<uint8_t>(
+         reinterpret_cast<const uint8_t*>(offsets.data()),
+         reinterpret_cast<const uint8_t*>(offsets.data()+offsets.size())));
+      Append(body,buffers,std::vector<uint8_t>(data.begin(),data.end()));
+   }
+
+   static FlatBuffer::Offset IntType(FlatBuffer& fb)
+   {
+      fb.Start();
+      fb.Field<int32_t>(0,32);
+      fb.Field<uint8_t>(1,1);
+      return fb.End();
+   }
+
+   FlatBuffer::Offset Schema(FlatBuffer& fb) const
+   {
+      std::vector<FlatBuffer::Offset> fields;
+      for(size_t i=0;i<Columns.size();i++){
+         const Column& column = Columns[i];
+         FlatBuffer::Offset name = fb.String(column.Name);
+         //Type union: Int = 2, FloatingPoint = 3, Utf8 = 5
+         uint8_t typetype;
+         FlatBuffer::Offset type;
+         if(column.Type == Int32){
+            typetype = 2;
+            type = IntType(fb);
+         }
+         else if(column.Type == Float32 || column.Type == Float64){
+            typetype = 3;
+            fb.Start();
+            fb.Field<int16_t>(0,column.Type==Float32?1:2);
+            type = fb.End();
+         }
+         else{
+            typetype = 5;
+            fb.Start();
+            type = fb.End();
+         }
+         FlatBuffer::Offset dictionary = 0;
+         if(column.Type == Dict){
+            FlatBuffer::Offset index = IntType(fb);
+            fb.Start();
+            fb.Field<int64_t>(0,i);
+            fb.FieldReference(1,index);
+            fb.Field<uint8_t>(2,0);
+            dictionary = fb.End();
+         }
+         FlatBuffer::Offset children = fb.Vector(std::vector<FlatBuffer::Offset>());
+         fb.Start();
+         fb.FieldReference(0,name);
+         fb.Field<uint8_t>(1,column.Type==Float32 || column.Type==Float64);
+         fb.Field<uint8_t>(2,typetype);
+         fb.FieldReference(3,type);
+         if(dictionary) fb.FieldReference(4,dictionary);
+         fb.FieldReference(5,children);
+         fields.push_back(fb.End());
+      }
+      FlatBuffer::Offset vector = fb.Vector(fields);
+      fb.Start();
+      fb.Field<int16_t>(0,0); //Little endian
+      fb.FieldReference(1,vector);
+      return fb.End();
+   }
+
+   static FlatBuffer::Offset RecordBatch(FlatBuffer& fb, int64_t length, const std::vector<Node>& nodes, const std::vector<Buffer>& buffers)
+   {
+      std::vector<uint8_t> data(nodes.size()*sizeof(Node));
+      if(nodes.size()) std::memcpy(data.data(),nodes.data(),data.size());
+      FlatBuffer::Offset nodesvector = fb.Structs(data,nodes.size(),8);
+      data.resize(buffers.size()*sizeof(Buffer));
+      if(buffers.size()) std::memcpy(data.data(),buffers.data(),data.size());
+      FlatBuffer::Offset buffersvector = fb.Structs(data,buffers.size(),8);
+      fb.Start();
+      fb.Field<int64_t>(0,length);
+      fb.FieldReference(1,nodesvector);
+      fb.FieldReference(2,buffersvector);
+      return fb.End();
+   }
+
+   static FlatBuffer::Offset Blocks(FlatBuffer& fb, const std::vector<Block>& blocks)
+   {
+      std::vector<uint8_t> data(blocks.size()*sizeof(Block));
+      if(blocks.size()) std::memcpy(data.data(),blocks.data(),data.size());
+      return fb.Structs(data,blocks.size(),8);
+   }
+
+   //Wrap a message header (union type: Schema = 1, DictionaryBatch = 2, RecordBatch = 3)
+   static std::vector<uint8_t> Header(FlatBuffer& fb, uint8_t type, FlatBuffer::Offset header, int64_t bodylength)
+   {
+      fb.Start();
+      fb.Field<int16_t>(0,Version);
+      fb.Field<uint8_t>(1,type);
+      fb.FieldReference(2,header);
+      fb.Field<int64_t>(3,bodylength);
+      return fb.Finish(fb.End());
+   }
+
+   //Write an encapsulated message: continuation marker, metadata length, metadata and body
+   static Block Message(std::ostream& file, int64_t& position, const std::vector<uint8_t>& metadata, const std::vector<uint8_t>& body)
+   {
+      Block block;
+      block.Offset = position;
+      block.Padding = 0;
+      int32_t length = (metadata.size()+7)/8*8;
+      block.MetaDataLength = 8+length;
+      block.BodyLength = body.size();
+      Scalar<uint32_t>(file,position,0xFFFFFFFF);
+      Scalar<int32_t>(file,position,length);
+      Bytes(file,position,metadata.data(),metadata.size());
+      Bytes(file,position,"\0\0\0\0\0\0\0",length-metadata.size());
+      Bytes(file,position,body.data(),body.size());
+      return block;
+   }
+
+   template<typename Type>
+   static void Scalar(std::ostream& file, int64_t& position, Type value)
+   {
+      Bytes(file,position,&value,sizeof(Type));
+   }
+
+   static void Bytes(std::ostream& file, int64_t& position, const void* data, size_t size)
+   {
+      file.write(static_cast<const char*>(data),size);
+      position += size;
+   }
+
+};//class ArrowTable
+
+
 //Data types
 class Record {
 public:
@@ -124,6 +862,7 @@ public:
       Event(0),
       Count(0),
       Source(0),
+      Bath(NAN),
       Recapture(nullptr)
    {}
 
@@ -228,7 +967,7 @@ public:
    }
 
    //Output
-   std::ofstream& Write(std::ofstream& file) const
+   std::ostream& Write(std::ostream& file) const
    {
       file<<Event<<"\t";
       file<<ID<<"\t";
@@ -249,7 +988,7 @@ public:
       return file;
    }
 
-   std::ofstream& LibertyWrite(std::ofstream& file)
+   std::ostream& LibertyWrite(std::ostream& file)
    {
       if(Recapture != 0){
          file<<Event<<"\t";
@@ -331,7 +1070,7 @@ public:
    }
 
    //Writes in the lob00 model format to a file given a cra area
-   std::ofstream& lob00Write(std::ofstream& file, int cra)
+   std::ostream& lob00Write(std::ostream& file, int cra)
    {
       if(lob00Valid(cra)){
          file<<Sex<<"\t"
@@ -344,7 +1083,7 @@ public:
    }
 
    //Writes in the lob01 model format to a file given a cra area
-   std::ofstream& lob01Write(std::ofstream& file,std::map<std::string,int>& typekey, int cra)
+   std::ostream& lob01Write(std::ostream& file,const std::map<std::string,int>& typekey, int cra)
    {
     if(lob01Valid(cra)){
             file<<Event<<"\t"
@@ -356,7 +1095,7 @@ public:
                <<Count<<"\t"
                <<Area<<"\t"
                <<Condition<<"\t"
-               <<typekey[Type]<<"\t"
+               <<TypeCode(typekey)<<"\t"
                <<1<<"\t" //Dummy column
                <<"\n";
       }
@@ -364,7 +1103,7 @@ public:
    }
 
 
-   std::ofstream& lob02Write(std::ofstream& file,std::map<std::string,int>& typekey)
+   std::ostream& lob02Write(std::ostream& file,const std::map<std::string,int>& typekey)
    {
             file<<Event<<"\t"
                <<Sex<<"\t"
@@ -375,13 +1114,13 @@ public:
                <<Count<<"\t"
                <<Area<<"\t"
                <<Condition<<"\t"
-               <<typekey[Type]<<"\t"
+               <<TypeCode(typekey)<<"\t"
                <<1<<"\t" //Dummy column
                <<"\n";
       return file;
    }
 
-   std::ofstream& lob02bWrite(std::ofstream& file,std::map<std::string,int>& typekey)
+   std::ostream& lob02bWrite(std::ostream& file,const std::map<std::string,int>& typekey)
    {
             file<<Event<<"\t"
                <<Sex<<"\t"
@@ -392,12 +1131,20 @@ public:
                <<Count<<"\t"
                <<Area<<"\t"
                <<Condition<<"\t"
-               <<typekey[Type]<<"\t"
+               <<TypeCode(typekey)<<"\t"
                <<(Recapture->Area)<<"\t" //Dummy column is now recapture area
                <<"\n";
       return file;
    }
 
+   //Numeric code for this record's tag type
+   int TypeCode(const std::map<std::string,int>& typekey) const
+   {
+      auto code = typekey.find(Type);
+      if(code != typekey.end()) return code->second;
+      else return 0;
+   }
+
    //Comparison operator so that can sort records in a set
    bool operator<(const Record& r) const
    {
@@ -528,6 +1275,28 @@ public:
       }
    }
 
+   //Look up the bathymetric depth at the position of every release and recapture.
+   //Records are visited in order of the grid tile that they fall in so that
+   //consecutive lookups read nearby parts of the grid.
+   void Bathymetries(const Bathymetry& bathymetry)
+   {
+      std::vector<std::pair<long,Record*>> lookups;
+      lookups.reserve(size());
+      //For each record...
+      for(iterator curr=begin();curr!=end();curr++){
+         long tile = bathymetry.Tile(curr->Lat,curr->Lon);
+         //..if position is on the grid then queue it, otherwise it has no bathymetry
+         if(tile>=0) lookups.push_back(std::make_pair(tile,&(*curr)));
+         else curr->Bath = NAN;
+      }
+      std::sort(lookups.begin(),lookups.end(),
+         [](const std::pair<long,Record*>& a, const std::pair<long,Record*>& b){
+            return a.first<b.first;
+         });
+      for(auto& lookup : lookups)
+         lookup.second->Bath = bathymetry.Lookup(lookup.second->Lat,lookup.second->Lon);
+   }
+
    void Process(void)
    {
       AssignCodes();
@@ -536,7 +1305,7 @@ public:
       Recaptures();
    }
 
-   void ReleasesWrite(std::ofstream& file)
+   void ReleasesWrite(std::ostream& file)
    {
       file<<"Event\tID\tProject\tTagType\tSex\tDateRel\tYearRel\tFYRel\tPeriodRel\tStageRel\t"
          <<"CondRel\tTWRel\tTWMethRel\tAreaRel\tLatRel\tLonRel\n";
@@ -548,7 +1317,7 @@ public:
       }
    }
 
-   void LibertyWrite(std::ofstream& file)
+   void LibertyWrite(std::ostream& file)
    {
       file<<"#Event\tID\tProject\tTagType\tSex\tDateRel\tDateRec\tDaysLib\tPeriodRel\t"
          <<"PeriodRec\tCountRel\tCountRec\tStageRel\tStageRec\tCondRel\tCondRec\t"
@@ -557,6 +1326,167 @@ public:
       for(iterator i=begin();i!=end();i++) i->LibertyWrite(file);
    }
 
+   void ExcludesWrite(std::ostream& file)
+   {
+      for(auto pair : Excludes) file<<pair.first<<"\t"<<pair.second<<"\n";
+   }
+
+   void TypeKeyWrite(std::ostream& file)
+   {
+      for(auto pair : TypeKey) file<<pair.first<<"\t"<<pair.second<<"\n";
+   }
+
+   //Arrow (Feather) versions of the above outputs with the same columns
+
+   bool ReleasesArrow(std::ostream& file)
+   {
+      std::vector<int32_t> event, sex, date, year, fy, period, stage, cond, twmeth, area;
+      std::vector<std::string> id, project, type;
+      std::vector<double> tw, lat, lon;
+      for(iterator i=begin();i!=end();i++){
+         if(i->Count == 0){
+            event.push_back(i->Event);
+            id.push_back(i->ID);
+            project.push_back(i->Project);
+            type.push_back(i->Type);
+            sex.push_back(i->Sex);
+            date.push_back(i->Date);
+            year.push_back(DateToCalendarYear(i->Date));
+            fy.push_back(DateToFishingYear(i->Date));
+            period.push_back(DateToPeriod(i->Date));
+            stage.push_back(i->Stage);
+            cond.push_back(i->Condition);
+            tw.push_back(i->TailWidth);
+            twmeth.push_back(i->TailWidthMethod);
+            area.push_back(i->Area);
+            lat.push_back(i->Lat);
+            lon.push_back(i->Lon);
+         }
+      }
+      ArrowTable table;
+      table.Int("Event",event);
+      table.Dictionary("ID",id);
+      table.Dictionary("Project",project);
+      table.Dictionary("TagType",type);
+      table.Int("Sex",sex);
+      table.Int("DateRel",date);
+      table.Int("YearRel",year);
+      table.Int("FYRel",fy);
+      table.Int("PeriodRel",period);
+      table.Int("StageRel",stage);
+      table.Int("CondRel",cond);
+      table.Double("TWRel",tw);
+      table.Int("TWMethRel",twmeth);
+      table.Int("AreaRel",area);
+      table.Double("LatRel",lat);
+      table.Double("LonRel",lon);
+      return table.Write(file);
+   }
+
+   bool LibertyArrow(std::ostream& file)
+   {
+      std::vector<int32_t> event, sex, daterel, daterec, dayslib, periodrel, periodrec, countrel, countrec,
+         stagerel, stagerec, condrel, condrec, twmethrel, twmethrec, arearel, arearec;
+      std::vector<std::string> id, project, type;
+      std::vector<double> twrel, twrec, latrel, lonrel, latrec, lonrec;
+      std::vector<float> depthrel, depthrec, bathrel, bathrec;
+      for(iterator i=begin();i!=end();i++){
+         const Record* recap = i->Recapture;
+         if(recap != 0){
+            event.push_back(i->Event);
+            id.push_back(i->ID);
+            project.push_back(i->Project);
+            type.push_back(i->Type);
+            sex.push_back(i->Sex);
+            daterel.push_back(i->Date);
+            daterec.push_back(recap->Date);
+            dayslib.push_back(recap->Date-i->Date);
+            periodrel.push_back(DateToPeriod(i->Date));
+            periodrec.push_back(DateToPeriod(recap->Date));
+            countrel.push_back(i->Count);
+            countrec.push_back(recap->Count);
+            stagerel.push_back(i->Stage);
+            stagerec.push_back(recap->Stage);
+            condrel.push_back(i->Condition);
+            condrec.push_back(recap->Condition);
+            twrel.push_back(i->TailWidth);
+            twmethrel.push_back(i->TailWidthMethod);
+            twrec.push_back(recap->TailWidth);
+            twmethrec.push_back(recap->TailWidthMethod);
+            arearel.push_back(i->Area);
+            arearec.push_back(recap->Area);
+            depthrel.push_back(i->Depth);
+            depthrec.push_back(recap->Depth);
+            latrel.push_back(i->Lat);
+            lonrel.push_back(i->Lon);
+            bathrel.push_back(i->Bath);
+            latrec.push_back(recap->Lat);
+            lonrec.push_back(recap->Lon);
+            bathrec.push_back(recap->Bath);
+         }
+      }
+      ArrowTable table;
+      table.Int("Event",event);
+      table.Dictionary("ID",id);
+      table.Dictionary("Project",project);
+      table.Dictionary("TagType",type);
+      table.Int("Sex",sex);
+      table.Int("DateRel",daterel);
+      table.Int("DateRec",daterec);
+      table.Int("DaysLib",dayslib);
+      table.Int("PeriodRel",periodrel);
+      table.Int("PeriodRec",periodrec);
+      table.Int("CountRel",countrel);
+      table.Int("CountRec",countrec);
+      table.Int("StageRel",stagerel);
+      table.Int("StageRec",stagerec);
+      table.Int("CondRel",condrel);
+      table.Int("CondRec",condrec);
+      table.Double("TWRel",twrel);
+      table.Int("TWMethRel",twmethrel);
+      table.Double("TWRec",twrec);
+      table.Int("TWMethRec",twmethrec);
+      table.Int("AreaRel",arearel);
+      table.Int("AreaRec",arearec);
+      table.Float("DepthRel",depthrel);
+      table.Float("DepthRec",depthrec);
+      table.Double("LatRel",latrel);
+      table.Double("LonRel",lonrel);
+      table.Float("BathRel",bathrel);
+      table.Double("LatRec",latrec);
+      table.Double("LonRec",lonrec);
+      table.Float("BathRec",bathrec);
+      return table.Write(file);
+   }
+
+   bool ExcludesArrow(std::ostream& file)
+   {
+      std::vector<std::string> id;
+      std::vector<int32_t> reason;
+      for(auto pair : Excludes){
+         id.push_back(pair.first);
+         reason.push_back(pair.second);
+      }
+      ArrowTable table;
+      table.String("ID",id);
+      table.Int("Reason",reason);
+      return table.Write(file);
+   }
+
+   bool TypeKeyArrow(std::ostream& file)
+   {
+      std::vector<std::string> type;
+      std::vector<int32_t> code;
+      for(auto pair : TypeKey){
+         type.push_back(pair.first);
+         code.push_back(pair.second);
+      }
+      ArrowTable table;
+      table.String("TagType",type);
+      table.Int("Code",code);
+      return table.Write(file);
+   }
+
    int lob00Number(int cra)
    {
       int number = 0;
@@ -593,7 +1523,7 @@ public:
       return number;
    }
 
-   void lob00Write(std::ofstream& file, int cra)
+   void lob00Write(std::ostream& file, int cra)
    {
       //Header
       file<<"#CRA"<<cra<<" tag release-recapures.\n";
@@ -606,7 +1536,7 @@ public:
       file<<"#Test\n"<<cra<<cra<<cra<<cra<<"\n";
    }
 
-   void lob01Write(std::ofstream& file, int cra, int max=1e6)
+   void lob01Write(std::ostream& file, int cra, int max=1e6)
    {
       //Header
       file<<"#CRA"<<cra<<" tag release-recapures.\n";
@@ -627,7 +1557,7 @@ public:
       file<<"#Test\n"<<cra<<cra<<cra<<cra<<"\n";
    }
    
-   void lob02Write(std::ofstream& file)
+   void lob02Write(std::ostream& file)
    {
       //Header
       file<<"#CRA 1 & 2 tag release-recapures.\n";
@@ -647,7 +1577,7 @@ public:
       file<<"#Test\n121212\n";
    }
 
-   void lob02bWrite(std::ofstream& file, int cra)
+   void lob02bWrite(std::ostream& file, int cra)
    {
       //Header
       file<<"#CRA"<<cra<<"tag release-recapures.\n";
@@ -669,7 +1599,224 @@ public:
 
 };//class Records
 
+//Resident server
+//Loads and processes the tag data once and then answers requests for exports
+//over a local Unix socket. Each connection sends a single line command, e.g.
+//
+//   echo "lob01 3 500" | nc -U cratag.sock
+//
+//and receives the output that would otherwise be written to file. Requests are
+//handled concurrently on the current, read only, set of records. The input file is
+//watched and when it changes a new set of records is processed and swapped in;
+//requests already underway keep using the set that they started with.
+class Server {
+public:
+   Server(const std::string& input, const std::string& socket):
+      Input(input),
+      Socket(socket),
+      Current(std::make_shared<Records>()),
+      Modified()
+   {}
+
+   int Run(void)
+   {
+      if(not Grid.Open("bathymetry")) Grid.Open("bathymetry.asc");
+      Reload();
+
+      int fd = ::socket(AF_UNIX,SOCK_STREAM,0);
+      if(fd<0){
+         std::cerr<<"Unable to create socket\n";
+         return 1;
+      }
+      sockaddr_un address;
+      std::memset(&address,0,sizeof(address));
+      address.sun_family = AF_UNIX;
+      if(Socket.size()>=sizeof(address.sun_path)){
+         std::cerr<<"Socket path too long: "<<Socket<<"\n";
+         close(fd);
+         return 1;
+      }
+      std::strcpy(address.sun_path,Socket.c_str());
+      //Remove any socket left over from a previous run but never anything else
+      struct stat existing;
+      if(lstat(Socket.c_str(),&existing)==0){
+         if(not S_ISSOCK(existing.st_mode)){
+            std::cerr<<"Not replacing "<<Socket<<" because it is not a socket\n";
+            close(fd);
+            return 1;
+         }
+         //Only replace the socket if nothing is listening on it any more
+         int probe = ::socket(AF_UNIX,SOCK_STREAM,0);
+         bool stale = probe>=0 && connect(probe,reinterpret_cast<sockaddr*>(&address),sizeof(address))!=0 && errno==ECONNREFUSED;
+         if(probe>=0) close(probe);
+         if(not stale){
+            std::cerr<<"Not replacing "<<Socket<<" because another server is using it\n";
+            close(fd);
+            return 1;
+         }
+         unlink(Socket.c_str());
+      }
+      if(bind(fd,reinterpret_cast<sockaddr*>(&address),sizeof(address))!=0 || listen(fd,16)!=0){
+         std::cerr<<"Unable to listen on "<<Socket<<"\n";
+         close(fd);
+         return 1;
+      }
+      std::cout<<"Serving on "<<Socket<<std::endl;
+
+      //Watch the input file for changes
+      std::thread watcher([this](){
+         while(true){
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            struct stat info;
+            LastModified(info);
+            if(not Same(info,Modified)) Reload();
+         }
+      });
+      watcher.detach();
+
+      //Handle each connection on its own thread
+      while(true){
+         int client = accept(fd,nullptr,nullptr);
+         if(client<0){
+            //Out of file descriptors so wait for some connections to finish
+            if(errno==EMFILE || errno==ENFILE) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+         }
+         //Don't let a client that never sends (or reads) tie up a thread for good
+         timeval timeout;
+         timeout.tv_sec = 10;
+         timeout.tv_usec = 0;
+         setsockopt(client,SOL_SOCKET,SO_RCVTIMEO,&timeout,sizeof(timeout));
+         setsockopt(client,SOL_SOCKET,SO_SNDTIMEO,&timeout,sizeof(timeout));
+         std::thread([this,client](){
+            Handle(client);
+            close(client);
+         }).detach();
+      }
+      return 0;
+   }
+
+private:
+   std::string Input;
+   std::string Socket;
+   Bathymetry Grid;
+
+   //The current set of records and the status of the input file when last checked
+   std::shared_ptr<Records> Current;
+   struct stat Modified;
+   std::mutex Mutex;
+
+   //Status of the input file, zeroed and false returned if it does not exist
+   bool LastModified(struct stat& info) const
+   {
+      if(stat(Input.c_str(),&info)==0) return true;
+      std::memset(&info,0,sizeof(info));
+      return false;
+   }
+
+   //Whether two file statuses are for the same version of a file. Modification times
+   //are compared to the nanosecond, along with size and inode in case a rewrite falls
+   //within the resolution of the file system's timestamps.
+   static bool Same(const struct stat& a, const struct stat& b)
+   {
+      return a.st_mtim.tv_sec==b.st_mtim.tv_sec && a.st_mtim.tv_nsec==b.st_mtim.tv_nsec
+         && a.st_size==b.st_size && a.st_ino==b.st_ino && a.st_dev==b.st_dev;
+   }
+
+   //Read and process the input into a new set of records and then make it current.
+   //The current records are kept if the input is missing or changes while being read.
+   void Reload(void)
+   {
+      struct stat before, after;
+      if(not LastModified(before) or not std::ifstream(Input).good()){
+         std::cerr<<"Unable to read "<<Input<<", keeping the current records"<<std::endl;
+         //Don't try again until the input changes
+         Modified = before;
+         return;
+      }
+      std::shared_ptr<Records> tags = std::make_shared<Records>();
+      tags->Read(Input);
+      tags->AssignCodes();
+      tags->Process();
+      if(Grid.Good()) tags->Bathymetries(Grid);
+      //The input may have been rewritten while it was being read. If so, drop these
+      //records and leave `Modified` as it was so that the next check tries again.
+      LastModified(after);
+      if(not Same(before,after)){
+         std::cerr<<Input<<" changed while being read, will reload"<<std::endl;
+         return;
+      }
+
+      std::lock_guard<std::mutex> lock(Mutex);
+      Current = tags;
+      Modified = after;
+      std::cout<<"Loaded "<<tags->size()<<" records from "<<Input<<std::endl;
+   }
+
+   std::shared_ptr<Records> Snapshot(void)
+   {
+      std::lock_guard<std::mutex> lock(Mutex);
+      return Current;
+   }
+
+   void Handle(int client)
+   {
+      //Read the command line
+      std::string line;
+      char c;
+      while(line.size()<1024 && recv(client,&c,1,0)==1 && c!='\n') line += c;
+
+      std::istringstream command(line);
+      std::string name;
+      command>>name;
+      //Optional numeric arguments: CRA and maximum number of rows
+      int cra = 0, max = 1e6, value;
+      if(command>>value){
+         cra = value;
+         if(command>>value) max = value;
+      }
+      bool invalid = command.fail() && not command.eof();
+
+      std::shared_ptr<Records> tags = Snapshot();
+      std::ostringstream out;
+      if(invalid) out<<"#Invalid arguments: "<<line<<"\n";
+      else if(name=="releases") tags->ReleasesWrite(out);
+      else if(name=="liberty") tags->LibertyWrite(out);
+      else if(name=="lob00") tags->lob00Write(out,cra);
+      else if(name=="lob01") tags->lob01Write(out,cra,max);
+      else if(name=="lob02") tags->lob02Write(out);
+      else if(name=="lob02b") tags->lob02bWrite(out,cra);
+      else if(name=="excludes") tags->ExcludesWrite(out);
+      else if(name=="tagkey") tags->TypeKeyWrite(out);
+      else if(name=="summary"){
+         out<<"Records\t"<<tags->size()<<"\n";
+         out<<"Unique\t"<<tags->Unique<<"\n";
+         out<<"Pairs\t"<<tags->PairsNum<<"\n";
+         out<<"Excludes\t"<<tags->Excludes.size()<<"\n";
+      }
+      else out<<"#Unknown command: "<<name<<"\n"
+              <<"#Commands: releases, liberty, lob00 <cra>, lob01 <cra> [max], lob02, lob02b <cra>, "
+              <<"excludes, tagkey, summary\n";
+
+      //Send the response
+      std::string response = out.str();
+      size_t sent = 0;
+      while(sent<response.size()){
+         ssize_t n = send(client,response.data()+sent,response.size()-sent,MSG_NOSIGNAL);
+         if(n<=0) break;
+         sent += n;
+      }
+   }
+
+};//class Server
+
 int main(int argc, char* argv[]){
+    //Resident server mode: cratag.exe serve [socket]
+    if(argc>1 && std::string(argv[1])=="serve"){
+        Server server("Records.txt",argc>2?argv[2]:"cratag.sock");
+        return server.Run();
+    }
+
     Records tags;
 
     //Read from data file
@@ -684,6 +1831,13 @@ int main(int argc, char* argv[]){
     std::cout<<"Processing tags\n";
     tags.Process();
 
+    //Add bathymetry if a grid is available
+    Bathymetry bathymetry;
+    if(bathymetry.Open("bathymetry") or bathymetry.Open("bathymetry.asc")){
+        std::cout<<"Bathymetry\n";
+        tags.Bathymetries(bathymetry);
+    }
+
     //Ouput inital releases
     std::cout<<"Releases output\n";
     std::ofstream releases("releases.dat");
@@ -697,12 +1851,23 @@ int main(int argc, char* argv[]){
     //Output excludes
     std::cout<<"Excludes output\n";
     std::ofstream excludes("excludes.dat");
-    for(auto pair : tags.Excludes) excludes<<pair.first<<"\t"<<pair.second<<"\n";
+    tags.ExcludesWrite(excludes);
 
     //Output tag types key
     std::cout<<"Tag type keys\n";
     std::ofstream tagkey("tagkey.out");
-    for(auto pair : tags.TypeKey) tagkey<<pair.first<<"\t"<<pair.second<<"\n";
+    tags.TypeKeyWrite(tagkey);
+
+    //Output Arrow (Feather) versions for reading from R and Python
+    std::cout<<"Arrow output\n";
+    std::ofstream releasesArrow("releases.arrow",std::ios::binary);
+    if(not tags.ReleasesArrow(releasesArrow)) std::cerr<<"Unable to write releases.arrow\n";
+    std::ofstream libertyArrow("liberty.arrow",std::ios::binary);
+    if(not tags.LibertyArrow(libertyArrow)) std::cerr<<"Unable to write liberty.arrow\n";
+    std::ofstream excludesArrow("excludes.arrow",std::ios::binary);
+    if(not tags.ExcludesArrow(excludesArrow)) std::cerr<<"Unable to write excludes.arrow\n";
+    std::ofstream tagkeyArrow("tagkey.arrow",std::ios::binary);
+    if(not tags.TypeKeyArrow(tagkeyArrow)) std::cerr<<"Unable to write tagkey.arrow\n";
 
     return 0;
 }